@@ -16,6 +16,9 @@ const int FAIM_MOUTON = 5;
 const int FAIM_LOUP = 10;
 const int ENERGIE_REPRODUCTION_MOUTON = 50;
 const int ENERGIE_REPRODUCTION_LOUP = 50;
+const int COUT_NAISSANCE_MOUTON = 30;
+const int COUT_NAISSANCE_LOUP = 50;
+const int TAILLE_BLOC_ACCOUPLEMENT = 3; // Un mâle et une femelle du même bloc peuvent s'accoupler
 
 // Couleurs
 const sf::Color COULEUR_HERBE(34, 139, 34);
@@ -44,7 +47,11 @@ public:
     
     virtual void deplacer(int tailleX, int tailleY) = 0;
     virtual void manger(class Univers& univers) = 0;
-    virtual bool reproduire(std::vector<std::unique_ptr<Entite>>& nouvellesEntites, int tailleX, int tailleY) = 0;
+    virtual void avancerReproduction() = 0;
+    virtual bool peutSAccoupler() const = 0;
+    virtual void sAccoupler() = 0;
+    virtual std::unique_ptr<Entite> creerPetit(int x, int y) const = 0;
+    virtual int getCoutNaissance() const = 0;
     virtual bool doitMourir() const = 0;
     virtual char getSymbole() const = 0;
     virtual std::string getType() const = 0;
@@ -149,41 +156,29 @@ public:
     
     void manger(class Univers& univers) override;
     
-    bool reproduire(std::vector<std::unique_ptr<Entite>>& nouvellesEntites, int tailleX, int tailleY) override {
+    void avancerReproduction() override {
         if (enceinte) {
             avancerGrossesse();
-            if (peutDonnerNaissance()) {
-                // Trouver une case adjacente libre
-                for (int dx = -1; dx <= 1; dx++) {
-                    for (int dy = -1; dy <= 1; dy++) {
-                        int nx = x + dx;
-                        int ny = y + dy;
-                        if (nx >= 0 && nx < tailleX && ny >= 0 && ny < tailleY) {
-                            // Vérifier si la case est libre (nécessite accès à l'univers)
-                            // Si libre:
-                            nouvellesEntites.push_back(std::make_unique<Mouton>(nx, ny, (rand() % 2) ? 'M' : 'F'));
-                            energie -= 30;
-                            accoucher();
-                            return true;
-                        }
-                    }
-                }
-                // Si aucune case libre, avorter
-                accoucher();
-            }
-            return false;
-        }
-        
-        if (age > 5 && energie > ENERGIE_REPRODUCTION_MOUTON && toursDepuisReproduction >= 10) {
-            devenirEnceinte();
-            toursDepuisReproduction = 0;
-            return true;
+        } else {
+            toursDepuisReproduction++;
         }
-        
-        toursDepuisReproduction++;
-        return false;
     }
     
+    bool peutSAccoupler() const override {
+        return !enceinte && age > 5 && energie > ENERGIE_REPRODUCTION_MOUTON && toursDepuisReproduction >= 10;
+    }
+    
+    void sAccoupler() override {
+        if (sexe == 'F') devenirEnceinte();
+        toursDepuisReproduction = 0;
+    }
+    
+    std::unique_ptr<Entite> creerPetit(int nx, int ny) const override {
+        return std::make_unique<Mouton>(nx, ny, (rand() % 2) ? 'M' : 'F');
+    }
+    
+    int getCoutNaissance() const override { return COUT_NAISSANCE_MOUTON; }
+    
     bool doitMourir() const override {
         return age > DUREE_MOUTON || energie <= 0 || getToursSansManger() > FAIM_MOUTON;
     }
@@ -234,41 +229,29 @@ public:
     
     void manger(class Univers& univers) override;
     
-    bool reproduire(std::vector<std::unique_ptr<Entite>>& nouvellesEntites, int tailleX, int tailleY) override {
+    void avancerReproduction() override {
         if (enceinte) {
             avancerGrossesse();
-            if (peutDonnerNaissance()) {
-                // Trouver une case adjacente libre
-                for (int dx = -1; dx <= 1; dx++) {
-                    for (int dy = -1; dy <= 1; dy++) {
-                        int nx = x + dx;
-                        int ny = y + dy;
-                        if (nx >= 0 && nx < tailleX && ny >= 0 && ny < tailleY) {
-                            // Vérifier si la case est libre (nécessite accès à l'univers)
-                            // Si libre:
-                            nouvellesEntites.push_back(std::make_unique<Loup>(nx, ny, (rand() % 2) ? 'M' : 'F'));
-                            energie -= 50;
-                            accoucher();
-                            return true;
-                        }
-                    }
-                }
-                // Si aucune case libre, avorter
-                accoucher();
-            }
-            return false;
-        }
-        
-        if (age > 10 && energie > ENERGIE_REPRODUCTION_LOUP && toursDepuisReproduction >= 15) {
-            devenirEnceinte();
-            toursDepuisReproduction = 0;
-            return true;
+        } else {
+            toursDepuisReproduction++;
         }
-        
-        toursDepuisReproduction++;
-        return false;
     }
     
+    bool peutSAccoupler() const override {
+        return !enceinte && age > 10 && energie > ENERGIE_REPRODUCTION_LOUP && toursDepuisReproduction >= 15;
+    }
+    
+    void sAccoupler() override {
+        if (sexe == 'F') devenirEnceinte();
+        toursDepuisReproduction = 0;
+    }
+    
+    std::unique_ptr<Entite> creerPetit(int nx, int ny) const override {
+        return std::make_unique<Loup>(nx, ny, (rand() % 2) ? 'M' : 'F');
+    }
+    
+    int getCoutNaissance() const override { return COUT_NAISSANCE_LOUP; }
+    
     bool doitMourir() const override {
         return age > DUREE_LOUP || energie <= 0 || getToursSansManger() > FAIM_LOUP;
     }
@@ -298,6 +281,89 @@ private:
     int moutonsManges;
     int herbeMangee;
     int herbeRepousse;
+    
+    // Tampons de reproduction, réutilisés d'un tour à l'autre
+    std::vector<char> caseOccupee;   // case (x * tailleY + y) occupée par un animal
+    std::vector<int> seauxEntites;   // seau d'accouplement de chaque entité (-1 si non éligible)
+    std::vector<int> debutSeaux;     // début de chaque seau dans candidats (tri par dénombrement)
+    std::vector<int> curseursSeaux;  // prochaine place libre de chaque seau pendant le remplissage
+    std::vector<Entite*> candidats;  // animaux éligibles, regroupés par bloc, espèce et sexe
+
+    // Place chaque petit dans une case adjacente libre ; sans case libre, la portée est perdue
+    void donnerNaissances(std::vector<std::unique_ptr<Entite>>& nouvellesEntites) {
+        caseOccupee.assign(tailleX * tailleY, 0);
+        for (const auto& entite : entites) {
+            caseOccupee[entite->getX() * tailleY + entite->getY()] = 1;
+        }
+        
+        for (auto& entite : entites) {
+            if (!entite->peutDonnerNaissance()) continue;
+            
+            bool ne = false;
+            for (int dx = -1; dx <= 1 && !ne; dx++) {
+                for (int dy = -1; dy <= 1 && !ne; dy++) {
+                    int nx = entite->getX() + dx;
+                    int ny = entite->getY() + dy;
+                    if (nx >= 0 && nx < tailleX && ny >= 0 && ny < tailleY && !caseOccupee[nx * tailleY + ny]) {
+                        caseOccupee[nx * tailleY + ny] = 1;
+                        nouvellesEntites.push_back(entite->creerPetit(nx, ny));
+                        entite->perdreEnergie(entite->getCoutNaissance());
+                        ne = true;
+                    }
+                }
+            }
+            entite->accoucher();
+            
+            if (ne) {
+                if (entite->getType() == "Mouton") naissancesMoutons++;
+                else naissancesLoups++;
+            }
+        }
+    }
+    
+    // Apparie mâles et femelles de la même espèce dans le même bloc de TAILLE_BLOC_ACCOUPLEMENT cases.
+    // Les éligibles sont répartis par tri par dénombrement (stable, donc dans l'ordre de entites),
+    // puis le i-ème mâle de chaque seau s'accouple avec la i-ème femelle : coût linéaire, résultat déterministe.
+    void accoupler() {
+        const int blocsX = (tailleX + TAILLE_BLOC_ACCOUPLEMENT - 1) / TAILLE_BLOC_ACCOUPLEMENT;
+        const int blocsY = (tailleY + TAILLE_BLOC_ACCOUPLEMENT - 1) / TAILLE_BLOC_ACCOUPLEMENT;
+        const int nbSeaux = blocsX * blocsY * 4; // 2 espèces x 2 sexes par bloc
+        
+        seauxEntites.resize(entites.size());
+        debutSeaux.assign(nbSeaux + 1, 0);
+        for (size_t i = 0; i < entites.size(); i++) {
+            const Entite& e = *entites[i];
+            if (!e.peutSAccoupler() || e.doitMourir()) {
+                seauxEntites[i] = -1;
+                continue;
+            }
+            int bloc = (e.getX() / TAILLE_BLOC_ACCOUPLEMENT) * blocsY + e.getY() / TAILLE_BLOC_ACCOUPLEMENT;
+            int espece = (e.getSymbole() == 'M') ? 0 : 1;
+            int femelle = (e.getSexe() == 'F') ? 1 : 0;
+            seauxEntites[i] = (bloc * 2 + espece) * 2 + femelle;
+            debutSeaux[seauxEntites[i] + 1]++;
+        }
+        for (int s = 0; s < nbSeaux; s++) {
+            debutSeaux[s + 1] += debutSeaux[s];
+        }
+        
+        candidats.resize(debutSeaux[nbSeaux]);
+        curseursSeaux.assign(debutSeaux.begin(), debutSeaux.end() - 1);
+        for (size_t i = 0; i < entites.size(); i++) {
+            if (seauxEntites[i] >= 0) {
+                candidats[curseursSeaux[seauxEntites[i]]++] = entites[i].get();
+            }
+        }
+        
+        // Seau pair : mâles, seau impair suivant : femelles de la même espèce et du même bloc
+        for (int s = 0; s < nbSeaux; s += 2) {
+            int m = debutSeaux[s], f = debutSeaux[s + 1];
+            for (; m < debutSeaux[s + 1] && f < debutSeaux[s + 2]; m++, f++) {
+                candidats[m]->sAccoupler();
+                candidats[f]->sAccoupler();
+            }
+        }
+    }
 
 public:
     Univers(int x, int y) 
@@ -364,27 +430,15 @@ public:
         for (auto& entite : entites) {
             entite->deplacer(tailleX, tailleY);
             entite->manger(*this);
-            
-            if (entite->reproduire(nouvellesEntites, tailleX, tailleY)) {
-                if (entite->getType() == "Mouton") {
-                    if (entite->estEnceinte()) {
-                        // La gestation est en cours
-                    } else {
-                        naissancesMoutons++;
-                    }
-                } else {
-                    if (entite->estEnceinte()) {
-                        // La gestation est en cours
-                    } else {
-                        naissancesLoups++;
-                    }
-                }
-            }
-            
+            entite->avancerReproduction();
             entite->vieillir();
             entite->incrementerToursSansManger();
         }
         
+        // Reproduction : naissances dans des cases libres, puis accouplements
+        donnerNaissances(nouvellesEntites);
+        accoupler();
+        
         // Ajouter les nouvelles entités
         for (auto& nouvelleEntite : nouvellesEntites) {
             entites.push_back(std::move(nouvelleEntite));